@@ -29,14 +29,19 @@ target_compile_options (opts
     $<$<AND:$<BOOL:${is_gcc}>,$<BOOL:${coverage}>>:-fprofile-arcs -ftest-coverage>
     $<$<AND:$<BOOL:${is_clang}>,$<BOOL:${coverage}>>:-fprofile-instr-generate -fcoverage-mapping>
     $<$<BOOL:${profile}>:-pg>
-    $<$<AND:$<BOOL:${is_gcc}>,$<BOOL:${profile}>>:-p>)
+    $<$<AND:$<BOOL:${is_gcc}>,$<BOOL:${profile}>>:-p>
+    $<$<STREQUAL:${pgo},generate>:-fprofile-generate>
+    $<$<STREQUAL:${pgo},use>:-fprofile-use>
+    $<$<AND:$<BOOL:${is_gcc}>,$<STREQUAL:${pgo},use>>:-fprofile-correction>)
 
 target_link_libraries (opts
   INTERFACE
     $<$<AND:$<BOOL:${is_gcc}>,$<BOOL:${coverage}>>:-fprofile-arcs -ftest-coverage>
     $<$<AND:$<BOOL:${is_clang}>,$<BOOL:${coverage}>>:-fprofile-instr-generate -fcoverage-mapping>
     $<$<BOOL:${profile}>:-pg>
-    $<$<AND:$<BOOL:${is_gcc}>,$<BOOL:${profile}>>:-p>)
+    $<$<AND:$<BOOL:${is_gcc}>,$<BOOL:${profile}>>:-p>
+    $<$<STREQUAL:${pgo},generate>:-fprofile-generate>
+    $<$<STREQUAL:${pgo},use>:-fprofile-use>)
 
 if (jemalloc)
   if (static)
@@ -18,6 +18,10 @@ endif ()
 if (is_gcc OR is_clang)
   option (coverage "Generates coverage info." OFF)
   option (profile "Add profiling flags" OFF)
+  set (pgo "" CACHE STRING
+    "On gcc & clang, profile-guided optimization. Set to 'generate' to build \
+    an instrumented binary, then rebuild with 'use' to optimize with the \
+    collected profile. Default is no PGO.")
   set (coverage_test "" CACHE STRING
     "On gcc & clang, the specific unit test(s) to run for coverage. Default is all tests.")
   if (coverage_test AND NOT coverage)
@@ -30,6 +34,7 @@ if (is_gcc OR is_clang)
   option (wextra "compile with extra gcc/clang warnings enabled" ON)
 else ()
   set (profile OFF CACHE BOOL "gcc/clang only" FORCE)
+  set (pgo "" CACHE STRING "gcc/clang only" FORCE)
   set (coverage OFF CACHE BOOL "gcc/clang only" FORCE)
   set (wextra OFF CACHE BOOL "gcc/clang only" FORCE)
 endif ()
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_DATA_DBINIT_H_INCLUDED
 
 #include <array>
+#include <climits>
 
 namespace ripple {
 
@@ -129,9 +130,23 @@ inline constexpr std::array<char const*, 1> AcquireShardDBInit{
 
 ////////////////////////////////////////////////////////////////////////////////
 
-// Pragma for Ledger and Transaction databases with complete shards
-inline constexpr std::array<char const*, 2> CompleteShardDBPragma{
-    {"PRAGMA synchronous=OFF;", "PRAGMA journal_mode=OFF;"}};
+// Pragma for Ledger and Transaction databases with complete shards.
+// These databases are read-mostly; serving pages via mmap avoids
+// copying them into SQLite's page cache.
+inline constexpr
+#if (ULONG_MAX > UINT_MAX) && !defined(NO_SQLITE_MMAP)
+    std::array<char const*, 4>
+        CompleteShardDBPragma{
+            {"PRAGMA synchronous=OFF;",
+             "PRAGMA journal_mode=OFF;",
+             "PRAGMA temp_store=MEMORY;",
+             "PRAGMA mmap_size=268435456;"}};
+#else
+    std::array<char const*, 3> CompleteShardDBPragma{
+        {"PRAGMA synchronous=OFF;",
+         "PRAGMA journal_mode=OFF;",
+         "PRAGMA temp_store=MEMORY;"}};
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
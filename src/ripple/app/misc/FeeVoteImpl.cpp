@@ -23,6 +23,8 @@
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/protocol/STValidation.h>
 #include <ripple/protocol/st.h>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 
 namespace ripple {
 
@@ -34,20 +36,58 @@ private:
     using value_type = XRPAmount;
     value_type const mCurrent;  // The current setting
     value_type const mTarget;   // The setting we want
-    std::map<value_type, int> mVoteMap;
+    value_type const mMin;      // Countable window, min(current, target)
+    value_type const mMax;      // Countable window, max(current, target)
+    value_type mBestValue;      // Winning in-window value seen so far
+    int mBestCount = 0;
+    // Contiguous, node-free storage: the number of distinct values voted
+    // for per flag ledger is small, so a flat map avoids a heap
+    // allocation per vote and keeps the tally cache-resident. Vote
+    // distributions almost always collapse to a handful of distinct
+    // values, so eight inline slots cover the steady state without any
+    // heap allocation at all.
+    boost::container::flat_map<
+        value_type,
+        int,
+        std::less<value_type>,
+        boost::container::small_vector<std::pair<value_type, int>, 8>>
+        mVoteMap;
 
 public:
     VotableValue(value_type current, value_type target)
-        : mCurrent(current), mTarget(target)
+        : mCurrent(current)
+        , mTarget(target)
+        , mMin(std::min(current, target))
+        , mMax(std::max(current, target))
+        , mBestValue(current)
     {
         // Add our vote
-        ++mVoteMap[mTarget];
+        addVote(mTarget);
     }
 
     void
     addVote(value_type vote)
     {
-        ++mVoteMap[vote];
+        auto const it = mVoteMap.lower_bound(vote);
+        int count;
+        if (it != mVoteMap.end() && it->first == vote)
+            count = ++it->second;
+        else
+        {
+            mVoteMap.emplace_hint(it, vote, 1);
+            count = 1;
+        }
+
+        // Track the winning in-window value as votes arrive so getVotes()
+        // needs no post-pass. Ties go to the lower value, matching the
+        // ascending-order scan this replaces.
+        if (vote >= mMin && vote <= mMax &&
+            (count > mBestCount ||
+             (count == mBestCount && vote < mBestValue)))
+        {
+            mBestValue = vote;
+            mBestCount = count;
+        }
     }
 
     void
@@ -56,28 +96,17 @@ public:
         addVote(mCurrent);
     }
 
-    value_type
-    getVotes() const;
-};
+    /** The most voted value between current and target, inclusive.
 
-auto
-VotableValue::getVotes() const -> value_type
-{
-    value_type ourVote = mCurrent;
-    int weight = 0;
-    for (auto const& [key, val] : mVoteMap)
+        Maintained incrementally by addVote; if no votes landed in the
+        window this is the current setting.
+    */
+    value_type
+    getVotes() const
     {
-        // Take most voted value between current and target, inclusive
-        if ((key <= std::max(mTarget, mCurrent)) &&
-            (key >= std::min(mTarget, mCurrent)) && (val > weight))
-        {
-            ourVote = key;
-            weight = val;
-        }
+        return mBestValue;
     }
-
-    return ourVote;
-}
+};
 
 }  // namespace detail
 
@@ -100,6 +129,17 @@ public:
         std::shared_ptr<ReadView const> const& lastClosedLedger,
         std::vector<std::shared_ptr<STValidation>> const& parentValidations,
         std::shared_ptr<SHAMap> const& initialPosition) override;
+
+private:
+    // Cold path, deliberately out of line: in steady state the tally
+    // matches the current fees and doVoting never gets here.
+    void
+    injectFeeChangeTx(
+        std::uint32_t seq,
+        std::uint64_t baseFee,
+        std::uint32_t baseReserve,
+        std::uint32_t incReserve,
+        std::shared_ptr<SHAMap> const& initialPosition);
 };
 
 //--------------------------------------------------------------------------
@@ -124,7 +164,9 @@ FeeVoteImpl::doValidation(Fees const& lastFees, STValidation& v)
             v.setFieldU64(sfBaseFee, *f);
     }
 
-    if (lastFees.accountReserve(0) != target_.account_reserve)
+    // accountReserve() computes its result; evaluate it once up front.
+    auto const baseReserve = lastFees.accountReserve(0);
+    if (baseReserve != target_.account_reserve)
     {
         JLOG(journal_.info())
             << "Voting for base reserve of " << target_.account_reserve;
@@ -152,103 +194,125 @@ FeeVoteImpl::doVoting(
     // LCL must be flag ledger
     assert((lastClosedLedger->info().seq % 256) == 0);
 
-    detail::VotableValue baseFeeVote(
-        lastClosedLedger->fees().base, target_.reference_fee);
+    // Snapshot the fees once; they are compared against repeatedly below.
+    Fees const& lastFees = lastClosedLedger->fees();
+    auto const lastBaseReserve = lastFees.accountReserve(0);
+
+    detail::VotableValue baseFeeVote(lastFees.base, target_.reference_fee);
 
     detail::VotableValue baseReserveVote(
-        lastClosedLedger->fees().accountReserve(0), target_.account_reserve);
+        lastBaseReserve, target_.account_reserve);
 
     detail::VotableValue incReserveVote(
-        lastClosedLedger->fees().increment, target_.owner_reserve);
+        lastFees.increment, target_.owner_reserve);
 
+    // Prefilter to trusted validations so the tally loop below runs
+    // branch-free over a contiguous array of raw pointers and feeds all
+    // three tallies in a single cache-hot pass.
+    std::vector<STValidation const*> trusted;
+    trusted.reserve(set.size());
     for (auto const& val : set)
     {
         if (val->isTrusted())
+            trusted.push_back(val.get());
+    }
+
+    for (auto const val : trusted)
+    {
+        if (val->isFieldPresent(sfBaseFee))
         {
-            if (val->isFieldPresent(sfBaseFee))
-            {
-                using xrptype = XRPAmount::value_type;
-                auto const vote = val->getFieldU64(sfBaseFee);
-                if (vote <= std::numeric_limits<xrptype>::max() &&
-                    isLegalAmount(XRPAmount{unsafe_cast<xrptype>(vote)}))
-                    baseFeeVote.addVote(
-                        XRPAmount{unsafe_cast<XRPAmount::value_type>(vote)});
-                else
-                    // Invalid amounts will be treated as if they're
-                    // not provided. Don't throw because this value is
-                    // provided by an external entity.
-                    baseFeeVote.noVote();
-            }
+            using xrptype = XRPAmount::value_type;
+            auto const vote = val->getFieldU64(sfBaseFee);
+            if (vote <= std::numeric_limits<xrptype>::max() &&
+                isLegalAmount(XRPAmount{unsafe_cast<xrptype>(vote)}))
+                baseFeeVote.addVote(
+                    XRPAmount{unsafe_cast<XRPAmount::value_type>(vote)});
             else
-            {
+                // Invalid amounts will be treated as if they're
+                // not provided. Don't throw because this value is
+                // provided by an external entity.
                 baseFeeVote.noVote();
-            }
+        }
+        else
+        {
+            baseFeeVote.noVote();
+        }
 
-            if (val->isFieldPresent(sfReserveBase))
-            {
-                baseReserveVote.addVote(
-                    XRPAmount{val->getFieldU32(sfReserveBase)});
-            }
-            else
-            {
-                baseReserveVote.noVote();
-            }
-
-            if (val->isFieldPresent(sfReserveIncrement))
-            {
-                incReserveVote.addVote(
-                    XRPAmount{val->getFieldU32(sfReserveIncrement)});
-            }
-            else
-            {
-                incReserveVote.noVote();
-            }
+        if (val->isFieldPresent(sfReserveBase))
+        {
+            baseReserveVote.addVote(XRPAmount{val->getFieldU32(sfReserveBase)});
+        }
+        else
+        {
+            baseReserveVote.noVote();
+        }
+
+        if (val->isFieldPresent(sfReserveIncrement))
+        {
+            incReserveVote.addVote(
+                XRPAmount{val->getFieldU32(sfReserveIncrement)});
+        }
+        else
+        {
+            incReserveVote.noVote();
         }
     }
 
     // choose our positions
     // If any of the values are invalid, send the current values.
-    auto const baseFee = baseFeeVote.getVotes().dropsAs<std::uint64_t>(
-        lastClosedLedger->fees().base);
-    auto const baseReserve = baseReserveVote.getVotes().dropsAs<std::uint32_t>(
-        lastClosedLedger->fees().accountReserve(0));
-    auto const incReserve = incReserveVote.getVotes().dropsAs<std::uint32_t>(
-        lastClosedLedger->fees().increment);
-    constexpr FeeUnit32 feeUnits = Setup::reference_fee_units;
+    auto const baseFee =
+        baseFeeVote.getVotes().dropsAs<std::uint64_t>(lastFees.base);
+    auto const baseReserve =
+        baseReserveVote.getVotes().dropsAs<std::uint32_t>(lastBaseReserve);
+    auto const incReserve =
+        incReserveVote.getVotes().dropsAs<std::uint32_t>(lastFees.increment);
     auto const seq = lastClosedLedger->info().seq + 1;
 
     // add transactions to our position
-    if ((baseFee != lastClosedLedger->fees().base) ||
-        (baseReserve != lastClosedLedger->fees().accountReserve(0)) ||
-        (incReserve != lastClosedLedger->fees().increment))
+    if ((baseFee != lastFees.base) || (baseReserve != lastBaseReserve) ||
+        (incReserve != lastFees.increment))
     {
-        JLOG(journal_.warn()) << "We are voting for a fee change: " << baseFee
-                              << "/" << baseReserve << "/" << incReserve;
+        injectFeeChangeTx(
+            seq, baseFee, baseReserve, incReserve, initialPosition);
+    }
+}
 
-        STTx feeTx(
-            ttFEE,
-            [seq, baseFee, baseReserve, incReserve, feeUnits](auto& obj) {
-                obj[sfAccount] = AccountID();
-                obj[sfLedgerSequence] = seq;
-                obj[sfBaseFee] = baseFee;
-                obj[sfReserveBase] = baseReserve;
-                obj[sfReserveIncrement] = incReserve;
-                obj[sfReferenceFeeUnits] = feeUnits.fee();
-            });
+void
+FeeVoteImpl::injectFeeChangeTx(
+    std::uint32_t seq,
+    std::uint64_t baseFee,
+    std::uint32_t baseReserve,
+    std::uint32_t incReserve,
+    std::shared_ptr<SHAMap> const& initialPosition)
+{
+    constexpr FeeUnit32 feeUnits = Setup::reference_fee_units;
 
-        uint256 txID = feeTx.getTransactionID();
+    JLOG(journal_.warn()) << "We are voting for a fee change: " << baseFee
+                          << "/" << baseReserve << "/" << incReserve;
 
-        JLOG(journal_.warn()) << "Vote: " << txID;
+    STTx feeTx(
+        ttFEE, [seq, baseFee, baseReserve, incReserve, feeUnits](auto& obj) {
+            obj[sfAccount] = AccountID();
+            obj[sfLedgerSequence] = seq;
+            obj[sfBaseFee] = baseFee;
+            obj[sfReserveBase] = baseReserve;
+            obj[sfReserveIncrement] = incReserve;
+            obj[sfReferenceFeeUnits] = feeUnits.fee();
+        });
 
-        Serializer s;
-        feeTx.add(s);
+    uint256 txID = feeTx.getTransactionID();
 
-        auto tItem = std::make_shared<SHAMapItem>(txID, s.peekData());
+    JLOG(journal_.warn()) << "Vote: " << txID;
 
-        if (!initialPosition->addGiveItem(std::move(tItem), true, false))
-        {
-            JLOG(journal_.warn()) << "Ledger already had fee change";
-        }
+    Serializer s;
+    feeTx.add(s);
+
+    // Hand the serialized buffer to the item rather than copying it.
+    auto tItem = std::make_shared<SHAMapItem>(txID, std::move(s));
+
+    if (!initialPosition->addGiveItem(std::move(tItem), true, false))
+    {
+        JLOG(journal_.warn()) << "Ledger already had fee change";
     }
 }
 
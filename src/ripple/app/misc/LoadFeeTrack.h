@@ -24,8 +24,8 @@
 #include <ripple/beast/utility/Journal.h>
 #include <ripple/json/json_value.h>
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <mutex>
 
 namespace ripple {
 
@@ -46,10 +46,9 @@ public:
     explicit LoadFeeTrack(
         beast::Journal journal = beast::Journal(beast::Journal::getNullSink()))
         : j_(journal)
-        , localTxnLoadFee_(lftNormalFee)
+        , localState_(packLocal(0, lftNormalFee))
         , remoteTxnLoadFee_(lftNormalFee)
         , clusterTxnLoadFee_(lftNormalFee)
-        , raiseCount_(0)
     {
     }
 
@@ -58,29 +57,25 @@ public:
     void
     setRemoteFee(std::uint32_t f)
     {
-        std::lock_guard sl(lock_);
-        remoteTxnLoadFee_ = f;
+        remoteTxnLoadFee_.store(f, std::memory_order_relaxed);
     }
 
     std::uint32_t
     getRemoteFee() const
     {
-        std::lock_guard sl(lock_);
-        return remoteTxnLoadFee_;
+        return remoteTxnLoadFee_.load(std::memory_order_relaxed);
     }
 
     std::uint32_t
     getLocalFee() const
     {
-        std::lock_guard sl(lock_);
-        return localTxnLoadFee_;
+        return localFee(localState_.load(std::memory_order_relaxed));
     }
 
     std::uint32_t
     getClusterFee() const
     {
-        std::lock_guard sl(lock_);
-        return clusterTxnLoadFee_;
+        return clusterTxnLoadFee_.load(std::memory_order_relaxed);
     }
 
     std::uint32_t
@@ -92,26 +87,27 @@ public:
     std::uint32_t
     getLoadFactor() const
     {
-        std::lock_guard sl(lock_);
         return std::max(
-            {clusterTxnLoadFee_, localTxnLoadFee_, remoteTxnLoadFee_});
+            {clusterTxnLoadFee_.load(std::memory_order_relaxed),
+             getLocalFee(),
+             remoteTxnLoadFee_.load(std::memory_order_relaxed)});
     }
 
     std::pair<std::uint32_t, std::uint32_t>
     getScalingFactors() const
     {
-        std::lock_guard sl(lock_);
+        auto const local = getLocalFee();
+        auto const remote = remoteTxnLoadFee_.load(std::memory_order_relaxed);
+        auto const cluster = clusterTxnLoadFee_.load(std::memory_order_relaxed);
 
         return std::make_pair(
-            std::max(localTxnLoadFee_, remoteTxnLoadFee_),
-            std::max(remoteTxnLoadFee_, clusterTxnLoadFee_));
+            std::max(local, remote), std::max(remote, cluster));
     }
 
     void
     setClusterFee(std::uint32_t fee)
     {
-        std::lock_guard sl(lock_);
-        clusterTxnLoadFee_ = fee;
+        clusterTxnLoadFee_.store(fee, std::memory_order_relaxed);
     }
 
     bool
@@ -122,19 +118,41 @@ public:
     bool
     isLoadedLocal() const
     {
-        std::lock_guard sl(lock_);
-        return (raiseCount_ != 0) || (localTxnLoadFee_ != lftNormalFee);
+        auto const state = localState_.load(std::memory_order_relaxed);
+        return (raiseCount(state) != 0) || (localFee(state) != lftNormalFee);
     }
 
     bool
     isLoadedCluster() const
     {
-        std::lock_guard sl(lock_);
-        return (raiseCount_ != 0) || (localTxnLoadFee_ != lftNormalFee) ||
-            (clusterTxnLoadFee_ != lftNormalFee);
+        return isLoadedLocal() ||
+            (clusterTxnLoadFee_.load(std::memory_order_relaxed) !=
+             lftNormalFee);
     }
 
 private:
+    // The raise count and the local fee are packed into one atomic so
+    // that raiseLocalFee/lowerLocalFee can update the pair with a single
+    // compare-exchange instead of serializing admission threads on a
+    // mutex.
+    static constexpr std::uint64_t
+    packLocal(std::uint32_t raiseCount, std::uint32_t fee)
+    {
+        return (static_cast<std::uint64_t>(raiseCount) << 32) | fee;
+    }
+
+    static constexpr std::uint32_t
+    raiseCount(std::uint64_t state)
+    {
+        return static_cast<std::uint32_t>(state >> 32);
+    }
+
+    static constexpr std::uint32_t
+    localFee(std::uint64_t state)
+    {
+        return static_cast<std::uint32_t>(state);
+    }
+
     static std::uint32_t constexpr lftNormalFee =
         256;  // 256 is the minimum/normal load factor
     static std::uint32_t constexpr lftFeeIncFraction =
@@ -144,13 +162,13 @@ private:
     static std::uint32_t constexpr lftFeeMax = lftNormalFee * 1000000;
 
     beast::Journal const j_;
-    std::mutex mutable lock_;
 
-    std::uint32_t localTxnLoadFee_;   // Scale factor, lftNormalFee = normal fee
-    std::uint32_t remoteTxnLoadFee_;  // Scale factor, lftNormalFee = normal fee
-    std::uint32_t
-        clusterTxnLoadFee_;  // Scale factor, lftNormalFee = normal fee
-    std::uint32_t raiseCount_;
+    // (raiseCount, localTxnLoadFee), lftNormalFee = normal fee
+    std::atomic<std::uint64_t> localState_;
+    // Scale factor, lftNormalFee = normal fee
+    std::atomic<std::uint32_t> remoteTxnLoadFee_;
+    // Scale factor, lftNormalFee = normal fee
+    std::atomic<std::uint32_t> clusterTxnLoadFee_;
 };
 
 //------------------------------------------------------------------------------
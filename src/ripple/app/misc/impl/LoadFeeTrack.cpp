@@ -26,59 +26,126 @@
 #include <ripple/ledger/ReadView.h>
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/jss.h>
+#include <boost/multiprecision/cpp_int.hpp>
 
 #include <cstdint>
 #include <numeric>
 #include <type_traits>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 namespace ripple {
 
+namespace {
+
+inline unsigned
+countTrailingZeroes(std::uint64_t v)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long result;
+    _BitScanForward64(&result, v);
+    return static_cast<unsigned>(result);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+}
+
+// Stein's binary GCD: shifts and subtractions only, no hardware divide.
+// std::gcd runs Euclid's algorithm with a 64-bit modulo per iteration,
+// which is much slower on a path exercised for every fee calculation.
+std::uint64_t
+binaryGCD(std::uint64_t u, std::uint64_t v)
+{
+    if (u == 0)
+        return v;
+    if (v == 0)
+        return u;
+
+    auto const shift = countTrailingZeroes(u | v);
+    u >>= countTrailingZeroes(u);
+    do
+    {
+        v >>= countTrailingZeroes(v);
+        if (u > v)
+            std::swap(u, v);
+        v -= u;
+    } while (v);
+
+    return u << shift;
+}
+
+}  // namespace
+
 bool
 LoadFeeTrack::raiseLocalFee()
 {
-    std::lock_guard sl(lock_);
+    std::uint32_t count;
+    std::uint32_t origFee;
+    std::uint32_t newFee;
 
-    if (++raiseCount_ < 2)
-        return false;
-
-    std::uint32_t origFee = localTxnLoadFee_;
+    auto state = localState_.load(std::memory_order_relaxed);
+    do
+    {
+        count = raiseCount(state) + 1;
+        origFee = localFee(state);
+        newFee = origFee;
 
-    // make sure this fee takes effect
-    if (localTxnLoadFee_ < remoteTxnLoadFee_)
-        localTxnLoadFee_ = remoteTxnLoadFee_;
+        if (count >= 2)
+        {
+            // make sure this fee takes effect
+            newFee = std::max(
+                newFee, remoteTxnLoadFee_.load(std::memory_order_relaxed));
 
-    // Increase slowly
-    localTxnLoadFee_ += (localTxnLoadFee_ / lftFeeIncFraction);
+            // Increase slowly
+            newFee += (newFee / lftFeeIncFraction);
 
-    if (localTxnLoadFee_ > lftFeeMax)
-        localTxnLoadFee_ = lftFeeMax;
+            if (newFee > lftFeeMax)
+                newFee = lftFeeMax;
+        }
+    } while (!localState_.compare_exchange_weak(
+        state,
+        packLocal(count, newFee),
+        std::memory_order_release,
+        std::memory_order_relaxed));
 
-    if (origFee == localTxnLoadFee_)
+    if (count < 2 || origFee == newFee)
         return false;
 
     JLOG(j_.debug()) << "Local load fee raised from " << origFee << " to "
-                     << localTxnLoadFee_;
+                     << newFee;
     return true;
 }
 
 bool
 LoadFeeTrack::lowerLocalFee()
 {
-    std::lock_guard sl(lock_);
-    std::uint32_t origFee = localTxnLoadFee_;
-    raiseCount_ = 0;
+    std::uint32_t origFee;
+    std::uint32_t newFee;
+
+    auto state = localState_.load(std::memory_order_relaxed);
+    do
+    {
+        origFee = localFee(state);
+        newFee = origFee;
 
-    // Reduce slowly
-    localTxnLoadFee_ -= (localTxnLoadFee_ / lftFeeDecFraction);
+        // Reduce slowly
+        newFee -= (newFee / lftFeeDecFraction);
 
-    if (localTxnLoadFee_ < lftNormalFee)
-        localTxnLoadFee_ = lftNormalFee;
+        if (newFee < lftNormalFee)
+            newFee = lftNormalFee;
+    } while (!localState_.compare_exchange_weak(
+        state,
+        packLocal(0, newFee),
+        std::memory_order_release,
+        std::memory_order_relaxed));
 
-    if (origFee == localTxnLoadFee_)
+    if (origFee == newFee)
         return false;
 
     JLOG(j_.debug()) << "Local load fee lowered from " << origFee << " to "
-                     << localTxnLoadFee_;
+                     << newFee;
     return true;
 }
 
@@ -105,7 +172,9 @@ scaleFeeLoad(
                 return val.value();
         };
 
-        if (auto const g = std::gcd(value(a), value(b)))
+        if (auto const g = binaryGCD(
+                static_cast<std::uint64_t>(value(a)),
+                static_cast<std::uint64_t>(value(b))))
         {
             a = value(a) / g;
             b = value(b) / g;
@@ -120,6 +189,19 @@ scaleFeeLoad(
     if (bUnlimited && (feeFactor > uRemFee) && (feeFactor < (4 * uRemFee)))
         feeFactor = uRemFee;
 
+    // In steady state the server is unloaded, the scaling factor equals
+    // the load base, and the fraction below collapses to
+    // fee * baseFee / fees.units. Skip the term reduction and overflow
+    // gymnastics entirely for that case.
+    if (feeFactor == feeTrack.getLoadBase())
+    {
+        auto const result =
+            mulDiv(fee, XRPAmount{fees.base}, FeeUnit64{fees.units});
+        if (!result.first)
+            Throw<std::overflow_error>("scaleFeeLoad");
+        return result.second;
+    }
+
     XRPAmount baseFee{fees.base};
     // Compute:
     // fee = fee * baseFee * feeFactor / (fees.units * lftNormalFee);
@@ -140,21 +222,33 @@ scaleFeeLoad(
     // Order fee and baseFee largest first
     // Normally, these types wouldn't be comparable or swappable.
     // This function is an exception.
-    if (fee.value() < baseFee.value())
     {
-        auto tmp = fee.value();
-        fee = baseFee.value();
-        baseFee = tmp;
+        // min/max compile to conditional moves; a data-dependent swap
+        // branch here mispredicts on mixed workloads.
+        auto const a = fee.value();
+        auto const b = static_cast<std::uint64_t>(baseFee.value());
+        fee = std::max(a, b);
+        baseFee = std::min(a, b);
     }
     // double check
     assert(fee.value() >= baseFee.value());
 
-    // If baseFee * feeFactor overflows, the final result will overflow
-    XRPAmount const baseFeeOverflow{
-        std::numeric_limits<XRPAmount::value_type>::max() / feeFactor};
-    if (baseFee > baseFeeOverflow)
+    // If baseFee * feeFactor overflows, the final result will overflow.
+    // A single widening multiply replaces the 64-bit divide the old
+    // "max / feeFactor" probe needed on every call.
     {
-        Throw<std::overflow_error>("scaleFeeLoad");
+        using namespace boost::multiprecision;
+        uint128_t scaled;
+        scaled = multiply(
+            scaled,
+            static_cast<std::uint64_t>(baseFee.value()),
+            static_cast<std::uint64_t>(feeFactor));
+        if (scaled >
+            static_cast<std::uint64_t>(
+                std::numeric_limits<XRPAmount::value_type>::max()))
+        {
+            Throw<std::overflow_error>("scaleFeeLoad");
+        }
     }
     baseFee *= feeFactor;
 
@@ -31,7 +31,7 @@ namespace compression_algorithms {
 /** Convenience wrapper for Throw
  * @param message Message to log/throw
  */
-inline void
+[[noreturn]] inline void
 doThrow(const char* message)
 {
     Throw<std::runtime_error>(message);
@@ -89,7 +89,10 @@ lz4Decompress(
         inSize,
         decompressedSize);
 
-    if (ret <= 0 || ret != decompressedSize)
+    // A negative error return converts to a value far larger than any
+    // valid size, so a single unsigned comparison covers both failure
+    // and short output.
+    if (static_cast<std::size_t>(ret) != decompressedSize)
         doThrow("lz4 decompress: failed");
 
     return decompressedSize;
@@ -111,7 +114,10 @@ lz4Decompress(
     std::uint8_t* decompressed,
     std::size_t decompressedSize)
 {
-    std::vector<std::uint8_t> compressed;
+    // Reused across calls on this thread so that fragmented messages do
+    // not cost a heap allocation each; the capacity is retained once the
+    // buffer has grown to the peer's typical message size.
+    thread_local std::vector<std::uint8_t> compressed;
     std::uint8_t const* chunk = nullptr;
     int chunkSize = 0;
     int copiedInSize = 0;
@@ -129,14 +135,17 @@ lz4Decompress(
                 copiedInSize = inSize;
                 break;
             }
-            compressed.resize(inSize);
+            // reserve + append below avoids resize()'s value-initializing
+            // write pass over bytes that are about to be overwritten.
+            compressed.clear();
+            compressed.reserve(inSize);
         }
 
         chunkSize = chunkSize < (inSize - copiedInSize)
             ? chunkSize
             : (inSize - copiedInSize);
 
-        std::copy(chunk, chunk + chunkSize, compressed.data() + copiedInSize);
+        compressed.insert(compressed.end(), chunk, chunk + chunkSize);
 
         copiedInSize += chunkSize;
 
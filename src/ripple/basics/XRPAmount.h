@@ -26,11 +26,13 @@
 #include <ripple/beast/utility/Zero.h>
 #include <ripple/json/json_value.h>
 
+#if !defined(__SIZEOF_INT128__)
 #include <boost/multiprecision/cpp_int.hpp>
-#include <boost/operators.hpp>
+#endif
 #include <boost/optional.hpp>
 
 #include <cstdint>
+#include <limits>
 #include <string>
 
 namespace ripple {
@@ -43,10 +45,15 @@ struct dropTag;
 
 }  // namespace feeunit
 
-class XRPAmount : private boost::totally_ordered<XRPAmount>,
-                  private boost::additive<XRPAmount>,
-                  private boost::equality_comparable<XRPAmount, std::int64_t>,
-                  private boost::additive<XRPAmount, std::int64_t>
+/** A wrapper around a signed count of drops.
+
+    The derived comparison and arithmetic operators are written out
+    below rather than generated through Boost.Operators so that the
+    class stays an unadorned trivially copyable wrapper around its
+    single std::int64_t; a vector of amounts then has the same layout
+    as a vector of the raw values.
+*/
+class XRPAmount
 {
 public:
     using unit_type = feeunit::dropTag;
@@ -164,7 +171,8 @@ public:
     constexpr int
     signum() const noexcept
     {
-        return (drops_ < 0) ? -1 : (drops_ ? 1 : 0);
+        // Branchless: compiles to two compares and a subtract.
+        return (drops_ > 0) - (drops_ < 0);
     }
 
     /** Returns the number of drops */
@@ -240,13 +248,100 @@ public:
     }
 };
 
+static_assert(
+    std::is_trivially_copyable_v<XRPAmount>,
+    "XRPAmount must remain trivially copyable");
+
+// Comparison and arithmetic operators derived from the members above;
+// these were previously generated by Boost.Operators.
+inline bool
+operator!=(XRPAmount const& lhs, XRPAmount const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline bool
+operator>(XRPAmount const& lhs, XRPAmount const& rhs)
+{
+    return rhs < lhs;
+}
+
+inline bool
+operator<=(XRPAmount const& lhs, XRPAmount const& rhs)
+{
+    return !(rhs < lhs);
+}
+
+inline bool
+operator>=(XRPAmount const& lhs, XRPAmount const& rhs)
+{
+    return !(lhs < rhs);
+}
+
+inline XRPAmount
+operator+(XRPAmount lhs, XRPAmount const& rhs)
+{
+    lhs += rhs;
+    return lhs;
+}
+
+inline XRPAmount
+operator-(XRPAmount lhs, XRPAmount const& rhs)
+{
+    lhs -= rhs;
+    return lhs;
+}
+
+inline bool
+operator==(XRPAmount::value_type lhs, XRPAmount const& rhs)
+{
+    return rhs == lhs;
+}
+
+inline bool
+operator!=(XRPAmount const& lhs, XRPAmount::value_type rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline bool
+operator!=(XRPAmount::value_type lhs, XRPAmount const& rhs)
+{
+    return !(rhs == lhs);
+}
+
+inline XRPAmount
+operator+(XRPAmount lhs, XRPAmount::value_type rhs)
+{
+    lhs += rhs;
+    return lhs;
+}
+
+inline XRPAmount
+operator+(XRPAmount::value_type lhs, XRPAmount rhs)
+{
+    rhs += lhs;
+    return rhs;
+}
+
+inline XRPAmount
+operator-(XRPAmount lhs, XRPAmount::value_type rhs)
+{
+    lhs -= rhs;
+    return lhs;
+}
+
 /** Number of drops per 1 XRP */
 constexpr XRPAmount DROPS_PER_XRP{1'000'000};
 
 constexpr double
 XRPAmount::decimalXRP() const
 {
-    return static_cast<double>(drops_) / DROPS_PER_XRP.drops();
+    // Multiplying by the reciprocal, which folds to a constant, is
+    // several times cheaper than dividing and exact at every
+    // precision this value is displayed with.
+    return static_cast<double>(drops_) *
+        (1.0 / static_cast<double>(DROPS_PER_XRP.drops()));
 }
 
 // Output XRPAmount as just the drops value.
@@ -270,11 +365,22 @@ mulRatio(
     std::uint32_t den,
     bool roundUp)
 {
-    using namespace boost::multiprecision;
+    // The built-in 128 bit type compiles to a handful of instructions
+    // where the boost emulation calls out of line; fall back to boost
+    // only where the compiler lacks it.
+#if defined(__SIZEOF_INT128__)
+    using int128_t = __int128;
+#else
+    using boost::multiprecision::int128_t;
+#endif
 
     if (!den)
         Throw<std::runtime_error>("division by zero");
 
+    // Shortcuts, since these happen a lot in the real world
+    if (num == den || amt.drops() == 0)
+        return amt;
+
     int128_t const amt128(amt.drops());
     auto const neg = amt.drops() < 0;
     auto const m = amt128 * num;
@@ -286,9 +392,12 @@ mulRatio(
         if (neg && !roundUp)
             r -= 1;
     }
-    if (r > std::numeric_limits<XRPAmount::value_type>::max())
+    // Check both bounds so the result is well defined regardless of
+    // which 128 bit implementation is in use.
+    if (r > std::numeric_limits<XRPAmount::value_type>::max() ||
+        r < std::numeric_limits<XRPAmount::value_type>::min())
         Throw<std::overflow_error>("XRP mulRatio overflow");
-    return XRPAmount(r.convert_to<XRPAmount::value_type>());
+    return XRPAmount(static_cast<XRPAmount::value_type>(r));
 }
 
 }  // namespace ripple
@@ -26,8 +26,6 @@
 #include <ripple/nodestore/impl/Shard.h>
 #include <ripple/protocol/digest.h>
 
-#include <boost/algorithm/string.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 
 namespace ripple {
 namespace NodeStore {
@@ -298,7 +296,11 @@ Shard::store(std::shared_ptr<Ledger const> const& ledger)
     JLOG(j_.debug()) << "shard " << index_ << " stored ledger sequence " << seq
                      << (backendComplete_ ? " . All ledgers stored" : "");
 
-    setFileStats(lock);
+    // Scanning the directory to refresh file stats costs a stat call per
+    // file; do it periodically while acquiring rather than on every
+    // stored ledger. The stats are always refreshed once complete.
+    if (backendComplete_ || seq % 256 == 0)
+        setFileStats(lock);
     return true;
 }
 
@@ -308,6 +310,11 @@ Shard::containsLedger(std::uint32_t seq) const
     if (seq < firstSeq_ || seq > lastSeq_)
         return false;
 
+    // Once complete, a shard contains every sequence in its range
+    // forever; answer hot read traffic without taking the lock.
+    if (backendComplete_.load(std::memory_order_acquire))
+        return true;
+
     std::lock_guard lock(mutex_);
     if (backendComplete_)
         return true;
@@ -350,8 +357,7 @@ Shard::getBackend() const
 bool
 Shard::isBackendComplete() const
 {
-    std::lock_guard lock(mutex_);
-    return backendComplete_;
+    return backendComplete_.load(std::memory_order_acquire);
 }
 
 std::shared_ptr<PCache>
@@ -681,37 +687,38 @@ Shard::initSQLite(std::lock_guard<std::recursive_mutex> const&)
         if (txSQLiteDB_)
             txSQLiteDB_.reset();
 
+        auto setCacheSize = [](DatabaseCon& db, int size) {
+            db.getSession() << "PRAGMA cache_size=-" +
+                    std::to_string(kilobytes(size)) + ";";
+        };
+
         if (backendComplete_)
         {
             lgrSQLiteDB_ = std::make_unique<DatabaseCon>(
                 setup, LgrDBName, CompleteShardDBPragma, LgrDBInit);
-            lgrSQLiteDB_->getSession() << boost::str(
-                boost::format("PRAGMA cache_size=-%d;") %
-                kilobytes(
-                    config.getValueFor(SizedItem::lgrDBCache, boost::none)));
+            setCacheSize(
+                *lgrSQLiteDB_,
+                config.getValueFor(SizedItem::lgrDBCache, boost::none));
 
             txSQLiteDB_ = std::make_unique<DatabaseCon>(
                 setup, TxDBName, CompleteShardDBPragma, TxDBInit);
-            txSQLiteDB_->getSession() << boost::str(
-                boost::format("PRAGMA cache_size=-%d;") %
-                kilobytes(
-                    config.getValueFor(SizedItem::txnDBCache, boost::none)));
+            setCacheSize(
+                *txSQLiteDB_,
+                config.getValueFor(SizedItem::txnDBCache, boost::none));
         }
         else
         {
             // The incomplete shard uses a Write Ahead Log for performance
             lgrSQLiteDB_ = std::make_unique<DatabaseCon>(
                 setup, LgrDBName, LgrDBPragma, LgrDBInit);
-            lgrSQLiteDB_->getSession() << boost::str(
-                boost::format("PRAGMA cache_size=-%d;") %
-                kilobytes(config.getValueFor(SizedItem::lgrDBCache)));
+            setCacheSize(
+                *lgrSQLiteDB_, config.getValueFor(SizedItem::lgrDBCache));
             lgrSQLiteDB_->setupCheckpointing(&app_.getJobQueue(), app_.logs());
 
             txSQLiteDB_ = std::make_unique<DatabaseCon>(
                 setup, TxDBName, TxDBPragma, TxDBInit);
-            txSQLiteDB_->getSession() << boost::str(
-                boost::format("PRAGMA cache_size=-%d;") %
-                kilobytes(config.getValueFor(SizedItem::txnDBCache)));
+            setCacheSize(
+                *txSQLiteDB_, config.getValueFor(SizedItem::txnDBCache));
             txSQLiteDB_->setupCheckpointing(&app_.getJobQueue(), app_.logs());
         }
     }
@@ -759,6 +766,29 @@ Shard::storeSQLite(
                     return false;
                 }
 
+                // Accumulate rows for every transaction in the ledger and
+                // insert them with one bulk-bound prepared statement so
+                // SQLite parses the statement once instead of compiling a
+                // unique SQL string per transaction.
+                std::vector<std::string> accountTxIDs;
+                std::vector<std::string> accountTxAccounts;
+                std::vector<std::uint32_t> accountTxLedgerSeqs;
+                std::vector<std::uint32_t> accountTxSeqs;
+
+                // Prepared once and re-executed with a rebound value for
+                // each transaction; the compiled statement is reused
+                // rather than re-parsed on every iteration.
+                std::string deleteTxID;
+                soci::statement deleteAccountTx =
+                    (session.prepare << "DELETE FROM AccountTransactions "
+                                        "WHERE TransID = :txID;",
+                     soci::use(deleteTxID));
+
+                // One serialization buffer for the whole ledger; erase()
+                // keeps the capacity so only the first transaction pays
+                // for growth.
+                Serializer s;
+
                 for (auto const& item : ledger->txs)
                 {
                     if (stop_)
@@ -769,36 +799,21 @@ Shard::storeSQLite(
                     auto const txMeta{std::make_shared<TxMeta>(
                         txID, ledger->seq(), *item.second)};
 
-                    session << "DELETE FROM AccountTransactions "
-                               "WHERE TransID = :txID;",
-                        soci::use(sTxID);
+                    deleteTxID = sTxID;
+                    deleteAccountTx.execute(true);
 
                     auto const& accounts = txMeta->getAffectedAccounts(j_);
                     if (!accounts.empty())
                     {
-                        auto const sTxnSeq{std::to_string(txMeta->getIndex())};
-                        auto const s{boost::str(
-                            boost::format("('%s','%s',%s,%s)") % sTxID % "%s" %
-                            sSeq % sTxnSeq)};
-                        std::string sql;
-                        sql.reserve((accounts.size() + 1) * 128);
-                        sql =
-                            "INSERT INTO AccountTransactions "
-                            "(TransID, Account, LedgerSeq, TxnSeq) VALUES ";
-                        sql += boost::algorithm::join(
-                            accounts |
-                                boost::adaptors::transformed(
-                                    [&](AccountID const& accountID) {
-                                        return boost::str(
-                                            boost::format(s) %
-                                            ripple::toBase58(accountID));
-                                    }),
-                            ",");
-                        sql += ';';
-                        session << sql;
-
-                        JLOG(j_.trace()) << "shard " << index_
-                                         << " account transaction: " << sql;
+                        auto const txnSeq{txMeta->getIndex()};
+                        for (auto const& account : accounts)
+                        {
+                            accountTxIDs.push_back(sTxID);
+                            accountTxAccounts.push_back(
+                                ripple::toBase58(account));
+                            accountTxLedgerSeqs.push_back(seq);
+                            accountTxSeqs.push_back(txnSeq);
+                        }
                     }
                     else
                     {
@@ -807,7 +822,7 @@ Shard::storeSQLite(
                             << sSeq << " affects no accounts";
                     }
 
-                    Serializer s;
+                    s.erase();
                     item.second->add(s);
                     session
                         << (STTx::getMetaSQLInsertReplaceHeader() +
@@ -815,6 +830,20 @@ Shard::storeSQLite(
                                 seq, sqlEscape(s.modData())) +
                             ';');
                 }
+
+                if (!accountTxIDs.empty())
+                {
+                    JLOG(j_.trace())
+                        << "shard " << index_ << " storing "
+                        << accountTxIDs.size() << " account transactions";
+
+                    session << "INSERT INTO AccountTransactions "
+                               "(TransID, Account, LedgerSeq, TxnSeq) "
+                               "VALUES (:txID, :account, :ledgerSeq, :txnSeq);",
+                        soci::use(accountTxIDs), soci::use(accountTxAccounts),
+                        soci::use(accountTxLedgerSeqs),
+                        soci::use(accountTxSeqs);
+                }
             }
 
             tr.commit();
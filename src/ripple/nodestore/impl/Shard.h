@@ -213,8 +213,10 @@ private:
 
     beast::Journal const j_;
 
-    // True if backend has stored all ledgers pertaining to the shard
-    bool backendComplete_{false};
+    // True if backend has stored all ledgers pertaining to the shard.
+    // Atomic so read paths can check it without acquiring mutex_; it
+    // transitions false to true exactly once, under the lock.
+    std::atomic<bool> backendComplete_{false};
 
     // Older shard without an acquire database or final key
     // Eventually there will be no need for this and should be removed
@@ -49,6 +49,11 @@ lz4_decompress(void const* in, std::size_t in_size, BufferFactory&& bf)
     auto const n = read_varint(p, in_size, result.second);
     if (n == 0)
         Throw<std::runtime_error>("lz4 decompress: n == 0");
+    // The declared size is read from untrusted input. An LZ4 block
+    // cannot expand by more than a factor of 255, so anything larger is
+    // corruption or an attempt to force a huge allocation.
+    if (result.second > (in_size - n) * 255 + 16)
+        Throw<std::runtime_error>("lz4 decompress: size");
     void* const out = bf(result.second);
     result.first = out;
     if (LZ4_decompress_safe(
@@ -21,12 +21,33 @@
 #define BEAST_NUDB_VARINT_H_INCLUDED
 
 #include <cstdint>
+#include <cstring>
 #include <nudb/detail/stream.hpp>
 #include <type_traits>
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 namespace ripple {
 namespace NodeStore {
 
+namespace detail {
+
+inline unsigned
+varint_ctz(std::uint64_t v)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long result;
+    _BitScanForward64(&result, v);
+    return static_cast<unsigned>(result);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+}
+
+}  // namespace detail
+
 // This is a variant of the base128 varint format from
 // google protocol buffers:
 // https://developers.google.com/protocol-buffers/docs/encoding#varints
@@ -55,8 +76,88 @@ template <class = void>
 std::size_t
 read_varint(void const* buf, std::size_t buflen, std::size_t& t)
 {
-    t = 0;
     std::uint8_t const* p = reinterpret_cast<std::uint8_t const*>(buf);
+
+    // Unrolled decode of up to four base-127 digits, which covers every
+    // value the nodestore writes (codec type tags and blob sizes well
+    // under 256 MB). A zero high-order digit is malformed and falls
+    // through to the generic loop below, which rejects it.
+    //
+    // With eight readable bytes the terminating digit (high bit clear)
+    // is located with a single SWAR mask instead of a byte-at-a-time
+    // branch per digit.
+    if (buflen >= 8)
+    {
+        std::uint64_t w;
+        std::memcpy(&w, p, 8);
+        if (auto const stops = ~w & 0x8080808080808080ULL)
+        {
+            unsigned const len = detail::varint_ctz(stops) / 8 + 1;
+            if (len == 1)
+            {
+                t = p[0];
+                return 1;
+            }
+            if (len <= 4 && p[len - 1] != 0)
+            {
+                switch (len)
+                {
+                    case 2:
+                        t = std::size_t{p[1]} * 127 + (p[0] & 0x7f);
+                        return 2;
+                    case 3:
+                        t = (std::size_t{p[2]} * 127 + (p[1] & 0x7f)) * 127 +
+                            (p[0] & 0x7f);
+                        return 3;
+                    default:
+                        t = ((std::size_t{p[3]} * 127 + (p[2] & 0x7f)) * 127 +
+                             (p[1] & 0x7f)) *
+                                127 +
+                            (p[0] & 0x7f);
+                        return 4;
+                }
+            }
+        }
+    }
+    else if (buflen >= 4)
+    {
+        std::size_t const d0 = p[0];
+        if (!(d0 & 0x80))
+        {
+            t = d0;
+            return 1;
+        }
+        if (!(p[1] & 0x80))
+        {
+            if (p[1] != 0)
+            {
+                t = std::size_t{p[1]} * 127 + (d0 & 0x7f);
+                return 2;
+            }
+        }
+        else if (!(p[2] & 0x80))
+        {
+            if (p[2] != 0)
+            {
+                t = (std::size_t{p[2]} * 127 + (p[1] & 0x7f)) * 127 +
+                    (d0 & 0x7f);
+                return 3;
+            }
+        }
+        else if (!(p[3] & 0x80))
+        {
+            if (p[3] != 0)
+            {
+                t = ((std::size_t{p[3]} * 127 + (p[2] & 0x7f)) * 127 +
+                     (p[1] & 0x7f)) *
+                        127 +
+                    (d0 & 0x7f);
+                return 4;
+            }
+        }
+    }
+
+    t = 0;
     std::size_t n = 0;
     while (p[n] & 0x80)
         if (++n >= buflen)
@@ -86,12 +187,27 @@ template <class T, std::enable_if_t<std::is_unsigned<T>::value>* = nullptr>
 std::size_t
 size_varint(T v)
 {
-    std::size_t n = 0;
+    // The digits are base 127, not the power of two used by protocol
+    // buffers, so a count-leading-zeroes closed form does not apply.
+    // Compare against powers of 127 instead: this answers in at most
+    // four predictable compares for every value the nodestore writes,
+    // where the divide loop cost one integer division per digit.
+    std::uint64_t x = v;
+    if (x < 127)
+        return 1;
+    if (x < 127ULL * 127)
+        return 2;
+    if (x < 127ULL * 127 * 127)
+        return 3;
+    if (x < 127ULL * 127 * 127 * 127)
+        return 4;
+    std::size_t n = 4;
+    x /= 127ULL * 127 * 127 * 127;
     do
     {
-        v /= 127;
+        x /= 127;
         ++n;
-    } while (v != 0);
+    } while (x != 0);
     return n;
 }
 
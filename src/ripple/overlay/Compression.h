@@ -22,7 +22,6 @@
 
 #include <ripple/basics/CompressionAlgorithms.h>
 #include <ripple/basics/Log.h>
-#include <lz4frame.h>
 
 namespace ripple {
 
@@ -26,13 +26,56 @@
 #include <boost/asio/buffers_iterator.hpp>
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <iterator>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace ripple {
 
+namespace detail {
+
+/** Allocator that leaves new elements default-initialized.
+
+    Message buffers are sized and then immediately overwritten in full
+    by protobuf serialization or LZ4 output; this allocator spares the
+    value-initializing pass std::vector::resize would otherwise make
+    over every byte first.
+*/
+template <class T>
+struct uninitialized_allocator : std::allocator<T>
+{
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "uninitialized_allocator requires a trivially copyable type");
+
+    template <class U>
+    struct rebind
+    {
+        using other = uninitialized_allocator<U>;
+    };
+
+    using std::allocator<T>::allocator;
+
+    template <class U>
+    void
+    construct(U* p) noexcept
+    {
+        ::new (static_cast<void*>(p)) U;
+    }
+
+    template <class U, class... Args>
+    void
+    construct(U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+}  // namespace detail
+
 // VFALCO NOTE If we forward declare Message and write out shared_ptr
 //             instead of using the in-class type alias, we can remove the
 //             entire ripple.pb.h from the main headers.
@@ -52,6 +95,9 @@ class Message : public std::enable_shared_from_this<Message>
     using Algorithm = compression::Algorithm;
 
 public:
+    using Buffer =
+        std::vector<std::uint8_t, detail::uninitialized_allocator<std::uint8_t>>;
+
     /** Constructor
      * @param message Protocol message to serialize
      * @param type Protocol message type
@@ -64,7 +110,7 @@ public:
      *     uncompressed (Compress::Off) payload buffer
      * @return Payload buffer
      */
-    std::vector<uint8_t> const&
+    Buffer const&
     getBuffer(Compressed tryCompressed);
 
     /** Get the traffic category */
@@ -75,10 +121,21 @@ public:
     }
 
 private:
-    std::vector<uint8_t> buffer_;
-    std::vector<uint8_t> bufferCompressed_;
+    Buffer buffer_;
+    Buffer bufferCompressed_;
     std::size_t category_;
-    std::once_flag once_flag_;
+
+    // Tracks the one-time lazy compression of the payload. A thread that
+    // moves the state from Uncompressed to Compressing runs compress();
+    // until it publishes Compressed, concurrent callers requesting the
+    // compressed buffer are handed the uncompressed one, which the
+    // getBuffer contract already allows.
+    enum class CompressState : std::uint8_t {
+        Uncompressed = 0,
+        Compressing,
+        Compressed
+    };
+    std::atomic<CompressState> compressState_{CompressState::Uncompressed};
 
     /** Set the payload header
      * @param in Pointer to the payload
@@ -19,7 +19,9 @@
 
 #include <ripple/overlay/Message.h>
 #include <ripple/overlay/impl/TrafficCount.h>
+#include <boost/endian/conversion.hpp>
 #include <cstdint>
+#include <cstring>
 
 namespace ripple {
 
@@ -41,7 +43,15 @@ Message::Message(::google::protobuf::Message const& message, int type)
     setHeader(buffer_.data(), messageBytes, type, Algorithm::None, 0);
 
     if (messageBytes != 0)
-        message.SerializeToArray(buffer_.data() + headerBytes, messageBytes);
+    {
+        // The ByteSizeLong/ByteSize call above cached the field sizes;
+        // serializing with the cached sizes skips the second walk over
+        // the message tree that SerializeToArray would perform.
+        [[maybe_unused]] auto* const end =
+            message.SerializeWithCachedSizesToArray(
+                buffer_.data() + headerBytes);
+        assert(end == buffer_.data() + headerBytes + messageBytes);
+    }
 }
 
 void
@@ -130,17 +140,20 @@ Message::setHeader(
     auto h = in;
 
     auto pack = [](std::uint8_t*& in, std::uint32_t size) {
-        *in++ = static_cast<std::uint8_t>(
-            (size >> 24) & 0x0F);  // leftmost 4 are compression bits
-        *in++ = static_cast<std::uint8_t>((size >> 16) & 0xFF);
-        *in++ = static_cast<std::uint8_t>((size >> 8) & 0xFF);
-        *in++ = static_cast<std::uint8_t>(size & 0xFF);
+        // One big-endian word store; the leftmost 4 bits are reserved
+        // for the compression bits and stored clear.
+        std::uint32_t const word =
+            boost::endian::native_to_big(size & 0x0FFFFFFF);
+        std::memcpy(in, &word, sizeof(word));
+        in += sizeof(word);
     };
 
     pack(in, payloadBytes);
 
-    *in++ = static_cast<std::uint8_t>((type >> 8) & 0xFF);
-    *in++ = static_cast<std::uint8_t>(type & 0xFF);
+    std::uint16_t const typeWord =
+        boost::endian::native_to_big(static_cast<std::uint16_t>(type));
+    std::memcpy(in, &typeWord, sizeof(typeWord));
+    in += sizeof(typeWord);
 
     if (comprAlgorithm != Algorithm::None)
     {
@@ -149,15 +162,34 @@ Message::setHeader(
     }
 }
 
-std::vector<uint8_t> const&
+Message::Buffer const&
 Message::getBuffer(Compressed tryCompressed)
 {
     if (tryCompressed == Compressed::Off)
         return buffer_;
 
-    std::call_once(once_flag_, &Message::compress, this);
+    auto state = compressState_.load(std::memory_order_acquire);
+    if (state == CompressState::Uncompressed)
+    {
+        auto expected = CompressState::Uncompressed;
+        if (compressState_.compare_exchange_strong(
+                expected,
+                CompressState::Compressing,
+                std::memory_order_acquire,
+                std::memory_order_acquire))
+        {
+            compress();
+            compressState_.store(
+                CompressState::Compressed, std::memory_order_release);
+            state = CompressState::Compressed;
+        }
+        else
+            state = expected;
+    }
 
-    if (bufferCompressed_.size() > 0)
+    // A caller racing the compressing thread sends uncompressed rather
+    // than wait; the payload is valid either way.
+    if (state == CompressState::Compressed && bufferCompressed_.size() > 0)
         return bufferCompressed_;
     else
         return buffer_;
@@ -166,8 +198,9 @@ Message::getBuffer(Compressed tryCompressed)
 int
 Message::getType(std::uint8_t const* in) const
 {
-    int type = (static_cast<int>(*(in + 4)) << 8) + *(in + 5);
-    return type;
+    std::uint16_t type;
+    std::memcpy(&type, in + 4, sizeof(type));
+    return boost::endian::big_to_native(type);
 }
 
 }  // namespace ripple
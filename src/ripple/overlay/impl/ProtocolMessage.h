@@ -26,10 +26,12 @@
 #include <ripple/overlay/impl/ZeroCopyStream.h>
 #include <ripple/protocol/messages.h>
 #include <boost/asio/buffer.hpp>
-#include <boost/asio/buffers_iterator.hpp>
+#include <boost/endian/conversion.hpp>
 #include <boost/system/error_code.hpp>
+#include <array>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -38,7 +40,7 @@ namespace ripple {
 
 /** Returns the name of a protocol message given its type. */
 template <class = void>
-std::string
+char const*
 protocolMessageName(int type)
 {
     switch (type)
@@ -112,26 +114,24 @@ struct MessageHeader
     compression::Algorithm algorithm = compression::Algorithm::None;
 };
 
-template <typename BufferSequence>
-auto
-buffersBegin(BufferSequence const& bufs)
-{
-    return boost::asio::buffers_iterator<BufferSequence, std::uint8_t>::begin(
-        bufs);
-}
-
 template <class BufferSequence>
 boost::optional<MessageHeader>
 parseMessageHeader(BufferSequence const& bufs, std::size_t size)
 {
     using namespace ripple::compression;
-    auto iter = buffersBegin(bufs);
+
+    // Copy the header into contiguous storage so the fields can be read
+    // with whole-word loads; a header may straddle buffers in the
+    // sequence and this is far cheaper than stepping a buffers_iterator
+    // over every byte.
+    std::array<std::uint8_t, headerBytesCompressed> header{};
+    boost::asio::buffer_copy(boost::asio::buffer(header), bufs);
 
     MessageHeader hdr;
-    auto const compressed = (*iter & 0x80) == 0x80;
+    auto const compressed = (header[0] & 0x80) == 0x80;
 
     // Check valid header
-    if ((*iter & 0xFC) == 0 || compressed)
+    if ((header[0] & 0xFC) == 0 || compressed)
     {
         hdr.header_size = compressed ? headerBytesCompressed : headerBytes;
 
@@ -140,26 +140,30 @@ parseMessageHeader(BufferSequence const& bufs, std::size_t size)
 
         if (compressed)
         {
-            uint8_t algorithm = (*iter & 0x70) >> 4;
+            uint8_t algorithm = (header[0] & 0x70) >> 4;
             if (algorithm !=
                 static_cast<std::uint8_t>(compression::Algorithm::LZ4))
                 return {};
             hdr.algorithm = compression::Algorithm::LZ4;
         }
 
-        for (int i = 0; i != 4; ++i)
-            hdr.payload_wire_size = (hdr.payload_wire_size << 8) + *iter++;
+        std::uint32_t word;
+        std::memcpy(&word, &header[0], sizeof(word));
         // clear the compression bits
-        hdr.payload_wire_size &= 0x03FFFFFF;
+        hdr.payload_wire_size =
+            boost::endian::big_to_native(word) & 0x03FFFFFF;
 
         hdr.total_wire_size = hdr.header_size + hdr.payload_wire_size;
 
-        for (int i = 0; i != 2; ++i)
-            hdr.message_type = (hdr.message_type << 8) + *iter++;
+        std::uint16_t type;
+        std::memcpy(&type, &header[4], sizeof(type));
+        hdr.message_type = boost::endian::big_to_native(type);
 
         if (compressed)
-            for (int i = 0; i != 4; ++i)
-                hdr.uncompressed_size = (hdr.uncompressed_size << 8) + *iter++;
+        {
+            std::memcpy(&word, &header[6], sizeof(word));
+            hdr.uncompressed_size = boost::endian::big_to_native(word);
+        }
 
         return hdr;
     }
@@ -178,11 +182,11 @@ invoke(MessageHeader const& header, Buffers const& buffers, Handler& handler)
 {
     auto const m = std::make_shared<T>();
 
-    ZeroCopyInputStream<Buffers> stream(buffers);
-    stream.Skip(header.header_size);
-
     if (header.algorithm != compression::Algorithm::None)
     {
+        ZeroCopyInputStream<Buffers> stream(buffers);
+        stream.Skip(header.header_size);
+
         std::vector<std::uint8_t> payload;
         payload.resize(header.uncompressed_size);
 
@@ -196,8 +200,27 @@ invoke(MessageHeader const& header, Buffers const& buffers, Handler& handler)
         if (payloadSize == 0 || !m->ParseFromArray(payload.data(), payloadSize))
             return false;
     }
-    else if (!m->ParseFromZeroCopyStream(&stream))
-        return false;
+    else if (
+        auto const first = *boost::asio::buffer_sequence_begin(buffers);
+        boost::asio::buffer_size(first) >= header.total_wire_size)
+    {
+        // The whole message sits in the sequence's first buffer, which
+        // is the norm for sockets reading into a single read buffer;
+        // parse in place rather than through the stream adapter.
+        if (!m->ParseFromArray(
+                static_cast<std::uint8_t const*>(first.data()) +
+                    header.header_size,
+                header.payload_wire_size))
+            return false;
+    }
+    else
+    {
+        ZeroCopyInputStream<Buffers> stream(buffers);
+        stream.Skip(header.header_size);
+
+        if (!m->ParseFromZeroCopyStream(&stream))
+            return false;
+    }
 
     handler.onMessageBegin(header.message_type, m, header.payload_wire_size);
     handler.onMessage(m);
@@ -61,84 +61,94 @@ TrafficCount::categorize(
         return inbound ? TrafficCount::category::get_set
                        : TrafficCount::category::share_set;
 
-    if (auto msg = dynamic_cast<protocol::TMLedgerData const*>(&message))
+    // The remaining categories depend on message contents; type identifies
+    // the concrete protobuf class, so downcast statically rather than
+    // paying for RTTI on every message.
+    if (type == protocol::mtLEDGER_DATA)
     {
-        if (msg->type() == protocol::liTS_CANDIDATE)
-            return (inbound && !msg->has_requestcookie())
+        auto const& msg = static_cast<protocol::TMLedgerData const&>(message);
+
+        if (msg.type() == protocol::liTS_CANDIDATE)
+            return (inbound && !msg.has_requestcookie())
                 ? TrafficCount::category::ld_tsc_get
                 : TrafficCount::category::ld_tsc_share;
 
-        if (msg->type() == protocol::liTX_NODE)
-            return (inbound && !msg->has_requestcookie())
+        if (msg.type() == protocol::liTX_NODE)
+            return (inbound && !msg.has_requestcookie())
                 ? TrafficCount::category::ld_txn_get
                 : TrafficCount::category::ld_txn_share;
 
-        if (msg->type() == protocol::liAS_NODE)
-            return (inbound && !msg->has_requestcookie())
+        if (msg.type() == protocol::liAS_NODE)
+            return (inbound && !msg.has_requestcookie())
                 ? TrafficCount::category::ld_asn_get
                 : TrafficCount::category::ld_asn_share;
 
-        return (inbound && !msg->has_requestcookie())
+        return (inbound && !msg.has_requestcookie())
             ? TrafficCount::category::ld_get
             : TrafficCount::category::ld_share;
     }
 
-    if (auto msg = dynamic_cast<protocol::TMGetLedger const*>(&message))
+    if (type == protocol::mtGET_LEDGER)
     {
-        if (msg->itype() == protocol::liTS_CANDIDATE)
-            return (inbound || msg->has_requestcookie())
+        auto const& msg = static_cast<protocol::TMGetLedger const&>(message);
+
+        if (msg.itype() == protocol::liTS_CANDIDATE)
+            return (inbound || msg.has_requestcookie())
                 ? TrafficCount::category::gl_tsc_share
                 : TrafficCount::category::gl_tsc_get;
 
-        if (msg->itype() == protocol::liTX_NODE)
-            return (inbound || msg->has_requestcookie())
+        if (msg.itype() == protocol::liTX_NODE)
+            return (inbound || msg.has_requestcookie())
                 ? TrafficCount::category::gl_txn_share
                 : TrafficCount::category::gl_txn_get;
 
-        if (msg->itype() == protocol::liAS_NODE)
-            return (inbound || msg->has_requestcookie())
+        if (msg.itype() == protocol::liAS_NODE)
+            return (inbound || msg.has_requestcookie())
                 ? TrafficCount::category::gl_asn_share
                 : TrafficCount::category::gl_asn_get;
 
-        return (inbound || msg->has_requestcookie())
+        return (inbound || msg.has_requestcookie())
             ? TrafficCount::category::gl_share
             : TrafficCount::category::gl_get;
     }
 
-    if (auto msg = dynamic_cast<protocol::TMGetObjectByHash const*>(&message))
+    if (type == protocol::mtGET_OBJECTS)
     {
-        if (msg->type() == protocol::TMGetObjectByHash::otLEDGER)
-            return (msg->query() == inbound)
+        auto const& msg =
+            static_cast<protocol::TMGetObjectByHash const&>(message);
+
+        if (msg.type() == protocol::TMGetObjectByHash::otLEDGER)
+            return (msg.query() == inbound)
                 ? TrafficCount::category::share_hash_ledger
                 : TrafficCount::category::get_hash_ledger;
 
-        if (msg->type() == protocol::TMGetObjectByHash::otTRANSACTION)
-            return (msg->query() == inbound)
+        if (msg.type() == protocol::TMGetObjectByHash::otTRANSACTION)
+            return (msg.query() == inbound)
                 ? TrafficCount::category::share_hash_tx
                 : TrafficCount::category::get_hash_tx;
 
-        if (msg->type() == protocol::TMGetObjectByHash::otTRANSACTION_NODE)
-            return (msg->query() == inbound)
+        if (msg.type() == protocol::TMGetObjectByHash::otTRANSACTION_NODE)
+            return (msg.query() == inbound)
                 ? TrafficCount::category::share_hash_txnode
                 : TrafficCount::category::get_hash_txnode;
 
-        if (msg->type() == protocol::TMGetObjectByHash::otSTATE_NODE)
-            return (msg->query() == inbound)
+        if (msg.type() == protocol::TMGetObjectByHash::otSTATE_NODE)
+            return (msg.query() == inbound)
                 ? TrafficCount::category::share_hash_asnode
                 : TrafficCount::category::get_hash_asnode;
 
-        if (msg->type() == protocol::TMGetObjectByHash::otCAS_OBJECT)
-            return (msg->query() == inbound)
+        if (msg.type() == protocol::TMGetObjectByHash::otCAS_OBJECT)
+            return (msg.query() == inbound)
                 ? TrafficCount::category::share_cas_object
                 : TrafficCount::category::get_cas_object;
 
-        if (msg->type() == protocol::TMGetObjectByHash::otFETCH_PACK)
-            return (msg->query() == inbound)
+        if (msg.type() == protocol::TMGetObjectByHash::otFETCH_PACK)
+            return (msg.query() == inbound)
                 ? TrafficCount::category::share_fetch_pack
                 : TrafficCount::category::get_fetch_pack;
 
-        return (msg->query() == inbound) ? TrafficCount::category::share_hash
-                                         : TrafficCount::category::get_hash;
+        return (msg.query() == inbound) ? TrafficCount::category::share_hash
+                                        : TrafficCount::category::get_hash;
     }
 
     return TrafficCount::category::unknown;
@@ -27,6 +27,7 @@
 #include <ripple/nodestore/impl/DecodedBlob.h>
 #include <ripple/nodestore/impl/EncodedBlob.h>
 #include <ripple/nodestore/impl/Shard.h>
+#include <algorithm>
 #include <chrono>
 #include <test/jtx.h>
 #include <test/nodestore/TestBase.h>
@@ -60,10 +61,22 @@ class DatabaseShard_test : public TestBase
         /* nAccounts_[i] is the number of these accounts existed before i-th
          * ledger */
         std::vector<int> nAccounts_;
-        /* payAccounts_[i][j] = {from, to} is the pair which consists of two
-         * number of acoounts: source and destinations, which participate in
-         * j-th payment on i-th ledger */
-        std::vector<std::vector<std::pair<int, int>>> payAccounts_;
+        /* payFrom_[k] and payTo_[k] are the numbers of the source and
+         * destination accounts of the k-th payment; the payments belonging
+         * to the i-th ledger occupy indices payOffsets_[i] (inclusive)
+         * through payOffsets_[i + 1] (exclusive). Flat storage keeps the
+         * verification scans in testLedgerData on contiguous ints instead
+         * of chasing a vector per ledger */
+        std::vector<int> payFrom_;
+        std::vector<int> payTo_;
+        std::vector<std::uint32_t> payOffsets_;
+        /* accCreated_[i] is the number of the ledger on which the i-th
+         * account was funded */
+        std::vector<int> accCreated_;
+        /* sendCount_[i][j] is the number of payments sent by the i-th
+         * account on ledgers 0 .. j-1, so the count for any ledger range
+         * is a subtraction of two entries */
+        std::vector<std::vector<std::uint32_t>> sendCount_;
         /* xrpAmount_[i] is the amount for all payments on i-th ledger */
         std::vector<int> xrpAmount_;
         /* ledgers_[i] is the i-th ledger which contains the above described
@@ -80,7 +93,10 @@ class DatabaseShard_test : public TestBase
             std::uint32_t nLedgers = ledgersPerShard * nShards;
 
             nAccounts_.reserve(nLedgers);
-            payAccounts_.reserve(nLedgers);
+            payFrom_.reserve(nLedgers * dataSize);
+            payTo_.reserve(nLedgers * dataSize);
+            payOffsets_.reserve(nLedgers + 1);
+            payOffsets_.push_back(0);
             xrpAmount_.reserve(nLedgers);
 
             for (std::uint32_t i = 0; i < nLedgers; ++i)
@@ -91,36 +107,49 @@ class DatabaseShard_test : public TestBase
                 else
                     p = 0;
 
-                std::vector<std::pair<int, int>> pay;
-                pay.reserve(p);
-
                 for (int j = 0; j < p; ++j)
                 {
-                    int from, to;
-                    do
-                    {
-                        from = rand_int(rng_, n - 1);
-                        to = rand_int(rng_, n - 1);
-                    } while (from == to);
-
-                    pay.push_back(std::make_pair(from, to));
+                    // Draw the destination from the accounts other than
+                    // the source; shifting it past the source keeps the
+                    // pair distinct without rejection sampling.
+                    int const from = rand_int(rng_, n - 1);
+                    int to = rand_int(rng_, n - 2);
+                    if (to >= from)
+                        ++to;
+
+                    payFrom_.push_back(from);
+                    payTo_.push_back(to);
                 }
 
                 n += !rand_int(rng_, nLedgers / dataSize);
 
                 if (n > accounts_.size())
                 {
-                    char str[9];
-                    for (int j = 0; j < 8; ++j)
-                        str[j] = 'a' + rand_int(rng_, 'z' - 'a');
-                    str[8] = 0;
-                    accounts_.emplace_back(str);
+                    // A counter-derived name is just as unique as eight
+                    // random letters and identifies the account in
+                    // failure output.
+                    accounts_.emplace_back(
+                        "acc" + std::to_string(accounts_.size()));
+                    accCreated_.push_back(i);
                 }
 
                 nAccounts_.push_back(n);
-                payAccounts_.push_back(std::move(pay));
+                payOffsets_.push_back(
+                    static_cast<std::uint32_t>(payFrom_.size()));
                 xrpAmount_.push_back(rand_int(rng_, 90) + 10);
             }
+
+            sendCount_.resize(
+                accounts_.size(),
+                std::vector<std::uint32_t>(nLedgers + 1, 0));
+            for (std::uint32_t i = 0; i < nLedgers; ++i)
+            {
+                for (auto& counts : sendCount_)
+                    counts[i + 1] = counts[i];
+                for (std::uint32_t k = payOffsets_[i]; k < payOffsets_[i + 1];
+                     ++k)
+                    ++sendCount_[payFrom_[k]][i + 1];
+            }
         }
 
         bool
@@ -137,11 +166,12 @@ class DatabaseShard_test : public TestBase
             if (isNewAccounts(seq))
                 env_.fund(XRP(iniAmount), accounts_[nAccounts_[seq] - 1]);
 
-            for (std::uint32_t i = 0; i < payAccounts_[seq].size(); ++i)
+            for (std::uint32_t k = payOffsets_[seq]; k < payOffsets_[seq + 1];
+                 ++k)
             {
                 env_(
-                    pay(accounts_[payAccounts_[seq][i].first],
-                        accounts_[payAccounts_[seq][i].second],
+                    pay(accounts_[payFrom_[k]],
+                        accounts_[payTo_[k]],
                         XRP(xrpAmount_[seq])));
             }
         }
@@ -198,19 +228,18 @@ class DatabaseShard_test : public TestBase
                 {
                     if (id == data.accounts_[i].id())
                     {
-                        reqsq = ledgersPerShard + 1;
-                        for (int j = 0; j <= seq; ++j)
-                            if (data.nAccounts_[j] > i + 1 ||
-                                (data.nAccounts_[j] == i + 1 &&
-                                 !data.isNewAccounts(j)))
-                            {
-                                for (int k = 0; k < data.payAccounts_[j].size();
-                                     ++k)
-                                    if (data.payAccounts_[j][k].first == i)
-                                        reqsq++;
-                            }
-                            else
-                                reqsq++;
+                        // The sequence advances once per ledger up to and
+                        // including the funding ledger, and once per
+                        // payment sent afterwards; both counts come from
+                        // the tables built with the test data.
+                        int const created = data.accCreated_[i];
+                        int const s = static_cast<int>(seq);
+                        reqsq =
+                            ledgersPerShard + 2 + std::min(s, created);
+                        if (s > created)
+                            reqsq += static_cast<int>(
+                                data.sendCount_[i][s + 1] -
+                                data.sendCount_[i][created + 1]);
                         ++accCount;
                         break;
                     }
@@ -255,7 +284,10 @@ class DatabaseShard_test : public TestBase
         int newacc = data.isNewAccounts(seq) ? 1 : 0;
         BEAST_EXPECT(iniCount == newacc);
         BEAST_EXPECT(setCount == newacc);
-        BEAST_EXPECT(payCount == data.payAccounts_[seq].size());
+        BEAST_EXPECT(
+            payCount ==
+            static_cast<int>(
+                data.payOffsets_[seq + 1] - data.payOffsets_[seq]));
         BEAST_EXPECT(tothCount == !seq);
     }
 
@@ -279,7 +311,7 @@ class DatabaseShard_test : public TestBase
 
         // Store the state map
         auto visitAcc = [&](SHAMapAbstractNode& node) {
-            Serializer s;
+            Serializer s(1024);
             node.addRaw(s, snfPREFIX);
             db.store(
                 node.getType() == SHAMapAbstractNode::TNType::tnINNER
@@ -307,7 +339,7 @@ class DatabaseShard_test : public TestBase
 
         // Store the transaction map
         auto visitTx = [&](SHAMapAbstractNode& node) {
-            Serializer s;
+            Serializer s(1024);
             node.addRaw(s, snfPREFIX);
             db.store(
                 node.getType() == SHAMapAbstractNode::TNType::tnINNER
@@ -353,23 +385,21 @@ class DatabaseShard_test : public TestBase
 
         // walk shamap and validate each node
         auto fcompAcc = [&](SHAMapAbstractNode& node) -> bool {
-            Serializer s;
+            Serializer s(1024);
             node.addRaw(s, snfPREFIX);
-            auto nSrc{NodeObject::createObject(
-                node.getType() == SHAMapAbstractNode::TNType::tnINNER
-                    ? hotUNKNOWN
-                    : hotACCOUNT_NODE,
-                std::move(s.modData()),
-                node.getNodeHash().as_uint256())};
-            if (!BEAST_EXPECT(nSrc))
-                return false;
 
             auto nDst =
                 db.fetch(node.getNodeHash().as_uint256(), ledger.info().seq);
             if (!BEAST_EXPECT(nDst))
                 return false;
 
-            BEAST_EXPECT(isSame(nSrc, nDst));
+            BEAST_EXPECT(
+                nDst->getType() ==
+                (node.getType() == SHAMapAbstractNode::TNType::tnINNER
+                     ? hotUNKNOWN
+                     : hotACCOUNT_NODE));
+            BEAST_EXPECT(nDst->getHash() == node.getNodeHash().as_uint256());
+            BEAST_EXPECT(nDst->getData() == s.peekData());
 
             return true;
         };
@@ -377,23 +407,21 @@ class DatabaseShard_test : public TestBase
             ledger.stateMap().snapShot(false)->visitNodes(fcompAcc);
 
         auto fcompTx = [&](SHAMapAbstractNode& node) -> bool {
-            Serializer s;
+            Serializer s(1024);
             node.addRaw(s, snfPREFIX);
-            auto nSrc{NodeObject::createObject(
-                node.getType() == SHAMapAbstractNode::TNType::tnINNER
-                    ? hotUNKNOWN
-                    : hotTRANSACTION_NODE,
-                std::move(s.modData()),
-                node.getNodeHash().as_uint256())};
-            if (!BEAST_EXPECT(nSrc))
-                return false;
 
             auto nDst =
                 db.fetch(node.getNodeHash().as_uint256(), ledger.info().seq);
             if (!BEAST_EXPECT(nDst))
                 return false;
 
-            BEAST_EXPECT(isSame(nSrc, nDst));
+            BEAST_EXPECT(
+                nDst->getType() ==
+                (node.getType() == SHAMapAbstractNode::TNType::tnINNER
+                     ? hotUNKNOWN
+                     : hotTRANSACTION_NODE));
+            BEAST_EXPECT(nDst->getHash() == node.getNodeHash().as_uint256());
+            BEAST_EXPECT(nDst->getData() == s.peekData());
 
             return true;
         };
@@ -404,24 +432,16 @@ class DatabaseShard_test : public TestBase
     std::string
     bitmask2Rangeset(std::uint64_t bitmask)
     {
-        std::string set;
+        // An unset mask maps to an empty string, matching what the
+        // database reports when no shards qualify, while to_string on an
+        // empty RangeSet would produce "empty".
         if (!bitmask)
-            return set;
-        bool empty = true;
-
-        for (std::uint32_t i = 0; i < 64 && bitmask; i++)
-        {
-            if (bitmask & (1ll << i))
-            {
-                if (!empty)
-                    set += ",";
-                set += std::to_string(i);
-                empty = false;
-            }
-        }
+            return {};
 
         RangeSet<std::uint32_t> rs;
-        from_string(rs, set);
+        for (std::uint32_t i = 0; bitmask; ++i, bitmask >>= 1)
+            if (bitmask & 1)
+                rs.insert(i);
         return to_string(rs);
     }
 
@@ -488,7 +508,10 @@ class DatabaseShard_test : public TestBase
         {
             if (!BEAST_EXPECT(std::chrono::system_clock::now() < end))
                 return {};
-            std::this_thread::yield();
+            // Finalizing a shard takes a while; sleeping keeps this
+            // thread from spinning against the store's mutex while the
+            // work happens elsewhere.
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
 
         return shardNumber;
@@ -34,10 +34,10 @@
 #include <ripple/protocol/digest.h>
 #include <ripple/protocol/jss.h>
 #include <ripple/shamap/SHAMapNodeID.h>
-#include <boost/asio/ip/address_v4.hpp>
-#include <boost/beast/core/multi_buffer.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/endian/conversion.hpp>
 #include <algorithm>
+#include <cstring>
 #include <ripple.pb.h>
 #include <test/jtx/Account.h>
 #include <test/jtx/Env.h>
@@ -99,27 +99,27 @@ public:
                 (int)m.getBuffer(Compressed::Off).size(),
                 (int)m.getBuffer(Compressed::On).size());
 
-        boost::beast::multi_buffer buffers;
-
-        // simulate multi-buffer
+        // simulate multi-buffer with views into the message buffer; an
+        // owning multi_buffer would copy every payload byte twice before
+        // the parse even starts, which for the MB-sized LedgerData cases
+        // dominates the test without changing what is exercised
+        std::vector<boost::asio::const_buffer> buffers;
+        buffers.reserve(nbuffers);
         auto sz = buffer.size() / nbuffers;
         for (int i = 0; i < nbuffers; i++)
         {
-            auto start = buffer.begin() + sz * i;
-            auto end = i < nbuffers - 1 ? (buffer.begin() + sz * (i + 1))
-                                        : buffer.end();
-            std::vector<std::uint8_t> slice(start, end);
-            buffers.commit(boost::asio::buffer_copy(
-                buffers.prepare(slice.size()), boost::asio::buffer(slice)));
+            auto const len =
+                i < nbuffers - 1 ? sz : buffer.size() - sz * (nbuffers - 1);
+            buffers.emplace_back(buffer.data() + sz * i, len);
         }
         auto header =
-            ripple::detail::parseMessageHeader(buffers.data(), buffer.size());
+            ripple::detail::parseMessageHeader(buffers, buffer.size());
 
         if (log)
             printf(
                 "==> parsed header: buffers size %d, compressed %d, algorithm "
                 "%d, header size %d, payload size %d, buffer size %d\n",
-                (int)buffers.size(),
+                (int)boost::asio::buffer_size(buffers),
                 header->algorithm != Algorithm::None,
                 (int)header->algorithm,
                 (int)header->header_size,
@@ -133,13 +133,16 @@ public:
             return;
         }
 
-        std::vector<std::uint8_t> decompressed;
+        // the decompressor overwrites the buffer in full, so use the
+        // Message byte vector whose allocator skips the zeroing pass a
+        // plain resize would make over the 61MB LedgerData payloads
+        Message::Buffer decompressed;
         decompressed.resize(header->uncompressed_size);
 
         BEAST_EXPECT(
             header->payload_wire_size == buffer.size() - header->header_size);
 
-        ZeroCopyInputStream stream(buffers.data());
+        ZeroCopyInputStream stream(buffers);
         stream.Skip(header->header_size);
 
         auto decompressedSize = ripple::compression::decompress(
@@ -152,11 +155,17 @@ public:
 
         BEAST_EXPECT(
             proto1->ParseFromArray(decompressed.data(), decompressedSize));
-        auto uncompressed = m.getBuffer(Compressed::Off);
-        BEAST_EXPECT(std::equal(
-            uncompressed.begin() + ripple::compression::headerBytes,
-            uncompressed.end(),
-            decompressed.begin()));
+        // memcmp rather than std::equal: one call over both operands
+        // that the C library runs at full memory bandwidth, with no
+        // per-byte iterator stepping on the multi-MB payloads
+        auto const& uncompressed = m.getBuffer(Compressed::Off);
+        BEAST_EXPECT(
+            uncompressed.size() - ripple::compression::headerBytes ==
+                decompressed.size() &&
+            std::memcmp(
+                uncompressed.data() + ripple::compression::headerBytes,
+                decompressed.data(),
+                decompressed.size()) == 0);
         if (log)
             printf("\n");
     }
@@ -196,6 +205,22 @@ public:
         return manifests;
     }
 
+    /** Return a manifest list holding the first n entries of another.
+
+        Generating a manifest costs two key generations and two ed25519
+        signatures, so the test builds one list at the largest size and
+        serves the smaller cases as prefixes of it.
+    */
+    static std::shared_ptr<protocol::TMManifests>
+    firstManifests(protocol::TMManifests const& all, int n)
+    {
+        auto manifests = std::make_shared<protocol::TMManifests>();
+        manifests->mutable_list()->Reserve(n);
+        for (int i = 0; i < n; i++)
+            manifests->add_list()->CopyFrom(all.list(i));
+        return manifests;
+    }
+
     std::shared_ptr<protocol::TMEndpoints>
     buildEndpoints(int n)
     {
@@ -205,9 +230,11 @@ public:
         {
             auto* endpoint = endpoints->add_endpoints();
             endpoint->set_hops(i);
-            std::string addr = std::string("10.0.1.") + std::to_string(i);
+            // the fixture addresses are 10.0.1.<i>; assemble the word
+            // directly instead of formatting a dotted string and
+            // parsing it back
             endpoint->mutable_ipv4()->set_ipv4(boost::endian::native_to_big(
-                boost::asio::ip::address_v4::from_string(addr).to_uint()));
+                (10u << 24) | (1u << 8) | static_cast<std::uint8_t>(i)));
             endpoint->mutable_ipv4()->set_ipv4port(i);
         }
         endpoints->set_version(2);
@@ -292,10 +319,16 @@ public:
         ledgerData->set_error(protocol::TMReplyError::reNO_LEDGER);
         ledgerData->mutable_nodes()->Reserve(n);
         uint256 parentHash(0);
+        // the time keeper only supplies now() for the fixture
+        // timestamps; construct it once rather than per node
+        auto tk = make_TimeKeeper(logs.journal("TimeKeeper"));
+        // one serializer for the whole loop; a serialized LedgerInfo is
+        // 118 bytes, so reserving once and erasing per node spares n
+        // allocator round trips
+        Serializer nData(128);
         for (int i = 0; i < n; i++)
         {
             LedgerInfo info;
-            auto tk = make_TimeKeeper(logs.journal("TimeKeeper"));
             info.seq = i;
             info.parentCloseTime = tk->now();
             info.hash = ripple::sha512Half(i);
@@ -306,7 +339,7 @@ public:
             info.closeTimeResolution = tk->now().time_since_epoch();
             info.closeTime = tk->now();
             parentHash = ledgerHash(info);
-            Serializer nData;
+            nData.erase();
             ripple::addRaw(info, nData);
             ledgerData->add_nodes()->set_nodedata(
                 nData.getDataPtr(), nData.getLength());
@@ -315,6 +348,28 @@ public:
         return ledgerData;
     }
 
+    /** Return ledger data holding the first n nodes of another message.
+
+        Each node costs four sha512Half calls to build, so the test
+        builds the 500000-node fixture once and slices the smaller
+        cases out of it; a prefix is exactly what a smaller build
+        would have produced.
+    */
+    static std::shared_ptr<protocol::TMLedgerData>
+    firstLedgerData(protocol::TMLedgerData const& all, int n)
+    {
+        auto ledgerData = std::make_shared<protocol::TMLedgerData>();
+        ledgerData->set_ledgerhash(all.ledgerhash());
+        ledgerData->set_ledgerseq(all.ledgerseq());
+        ledgerData->set_type(all.type());
+        ledgerData->set_requestcookie(all.requestcookie());
+        ledgerData->set_error(all.error());
+        ledgerData->mutable_nodes()->Reserve(n);
+        for (int i = 0; i < n; i++)
+            ledgerData->add_nodes()->CopyFrom(all.nodes(i));
+        return ledgerData;
+    }
+
     std::shared_ptr<protocol::TMGetObjectByHash>
     buildGetObjectByHash()
     {
@@ -334,8 +389,6 @@ public:
             object->set_hash(hash.data(), hash.size());
             ripple::SHAMapNodeID sha(hash.data(), hash.size());
             object->set_nodeid(sha.getRawString());
-            object->set_index("");
-            object->set_data("");
             object->set_ledgerseq(i);
         }
         return getObject;
@@ -390,10 +443,16 @@ public:
         protocol::TMGetObjectByHash get_object;
         protocol::TMValidatorList validator_list;
 
+        auto const allManifests = buildManifests(100);
+
         // 4.5KB
-        doTest(buildManifests(20), protocol::mtMANIFESTS, 4, "TMManifests20");
+        doTest(
+            firstManifests(*allManifests, 20),
+            protocol::mtMANIFESTS,
+            4,
+            "TMManifests20");
         // 22KB
-        doTest(buildManifests(100), protocol::mtMANIFESTS, 4, "TMManifests100");
+        doTest(allManifests, protocol::mtMANIFESTS, 4, "TMManifests100");
         // 131B
         doTest(buildEndpoints(10), protocol::mtENDPOINTS, 4, "TMEndpoints10");
         // 1.3KB
@@ -406,33 +465,35 @@ public:
             "TMTransaction");
         // 87B
         doTest(buildGetLedger(), protocol::mtGET_LEDGER, 1, "TMGetLedger");
+        auto const allLedgerData = buildLedgerData(500000, *logs);
+
         // 61KB
         doTest(
-            buildLedgerData(500, *logs),
+            firstLedgerData(*allLedgerData, 500),
             protocol::mtLEDGER_DATA,
             10,
             "TMLedgerData500");
         // 122 KB
         doTest(
-            buildLedgerData(1000, *logs),
+            firstLedgerData(*allLedgerData, 1000),
             protocol::mtLEDGER_DATA,
             20,
             "TMLedgerData1000");
         // 1.2MB
         doTest(
-            buildLedgerData(10000, *logs),
+            firstLedgerData(*allLedgerData, 10000),
             protocol::mtLEDGER_DATA,
             50,
             "TMLedgerData10000");
         // 12MB
         doTest(
-            buildLedgerData(100000, *logs),
+            firstLedgerData(*allLedgerData, 100000),
             protocol::mtLEDGER_DATA,
             100,
             "TMLedgerData100000");
         // 61MB
         doTest(
-            buildLedgerData(500000, *logs),
+            allLedgerData,
             protocol::mtLEDGER_DATA,
             100,
             "TMLedgerData500000");